@@ -0,0 +1,127 @@
+/*  Keystroke latency example to serial port
+
+    Measures the time from a key code arriving in the PS2KeyAdvanced buffer
+    to the remapped character being written to the Serial port using baud
+    of 115,200, in the same loop() as the International example.
+
+    The arrival time is not known, so times are counted from the last pass
+    of loop() that found no key. This includes the time a key waits in the
+    buffer during delay(), and is at most one pass (about 10 ms) high.
+
+    Every key is remapped and echoed, typing L prints p50 and p99 latency in
+    microseconds for each stage, R resets the figures.
+
+      read    key read from PS2KeyAdvanced (includes buffer wait)
+      remap   after PS2KeyMap::remapEvent
+      output  after printing the character
+
+  IMPORTANT WARNING
+
+    If using a DUE or similar board with 3V3 I/O you MUST put a level translator
+    like a Texas Instruments TXS0102 or FET circuit as the signals are
+    Bi-directional (signals transmitted from both ends on same wire).
+
+    Failure to do so may damage your Arduino Due or similar board.
+
+  The circuit:
+   * KBD Clock (PS2 pin 1) to an interrupt pin on Arduino (this example pin 3)
+   * KBD Data (PS2 pin 5) to a data pin (this example pin 4)
+   * +5V from Arduino to PS2 pin 1
+   * GND from Arduino to PS2 pin 3
+
+   See International example for connector details and valid irq pins
+
+  Like the Original library and example this is under LGPL license.
+*/
+
+#include <PS2KeyAdvanced.h>
+#include <PS2KeyMap.h>
+#include <PS2KeyLatency.h>
+
+/* Keyboard constants  Change to suit your Arduino
+   define pins used for data and clock from keyboard */
+#define DATAPIN 4
+#define IRQPIN  3
+
+// Latency stages
+#define STAGE_READ    0
+#define STAGE_REMAP   1
+#define STAGE_OUTPUT  2
+
+PS2KeyAdvanced keyboard;
+PS2KeyMap keymap;
+PS2KeyLatency latency;
+
+PS2KeyEvent_t event;
+uint32_t idleTime;    // Last poll with no key, keys read later arrived after it
+
+
+void printLatency(uint32_t value) {
+  if (value == PS2_LATENCY_OVERFLOW) {
+    Serial.print(">49151");   // Beyond histogram range
+  }
+  else {
+    Serial.print(value);
+  }
+}
+
+
+void printStage(const char* name, uint8_t stage) {
+  Serial.print(name);
+  Serial.print(" p50 ");
+  printLatency(latency.percentile(stage, 50));
+  Serial.print(" us  p99 ");
+  printLatency(latency.percentile(stage, 99));
+  Serial.println(" us");
+}
+
+
+void setup() {
+  Serial.begin(115200);
+  Serial.println("PS2KeyMap Keystroke Latency:");
+  Serial.println(" L to print latency, R to reset");
+  keyboard.begin(DATAPIN, IRQPIN);
+  keyboard.setNoBreak(1);
+  keyboard.setNoRepeat(1);
+  idleTime = micros();
+}
+
+
+void loop() {
+  const uint32_t now = micros();
+
+  if (keyboard.available() > 0) {
+    event.time = idleTime;
+    event.code = keyboard.read();
+    latency.mark(STAGE_READ, &event, micros());
+
+    keymap.remapEvent(&event);
+    latency.mark(STAGE_REMAP, &event, micros());
+
+    if (event.code & 0xFF) {
+      Serial.write(event.code & 0xFF);
+      latency.mark(STAGE_OUTPUT, &event, micros());
+    }
+
+    switch (event.code & 0xFF) {
+      case 'L':
+      case 'l':
+              Serial.println();
+              Serial.print(latency.samples(STAGE_OUTPUT));
+              Serial.println(" keys");
+              printStage("read  ", STAGE_READ);
+              printStage("remap ", STAGE_REMAP);
+              printStage("output", STAGE_OUTPUT);
+              break;
+      case 'R':
+      case 'r':
+              latency.reset();
+              break;
+    }
+  }
+  else {
+    idleTime = now;
+  }
+
+  delay(10);
+}
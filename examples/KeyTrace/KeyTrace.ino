@@ -0,0 +1,71 @@
+/*  Key code capture example to serial port
+
+    Records every key code from PS2KeyAdvanced as a compact PS2KeyTrace
+    log written in binary to the Serial port using baud of 115,200
+
+    Capture the serial output to a file on the PC and decode it with
+    extra/host/TraceDecode.cpp, which also remaps the keys with PS2KeyMap.
+
+    Holding a key down sends about 18 bytes per 63 auto-repeats. The
+    trace is flushed when no key has been received for a second.
+
+  IMPORTANT WARNING
+
+    If using a DUE or similar board with 3V3 I/O you MUST put a level translator
+    like a Texas Instruments TXS0102 or FET circuit as the signals are
+    Bi-directional (signals transmitted from both ends on same wire).
+
+    Failure to do so may damage your Arduino Due or similar board.
+
+  The circuit:
+   * KBD Clock (PS2 pin 1) to an interrupt pin on Arduino (this example pin 3)
+   * KBD Data (PS2 pin 5) to a data pin (this example pin 4)
+   * +5V from Arduino to PS2 pin 1
+   * GND from Arduino to PS2 pin 3
+
+   See International example for connector details and valid irq pins
+
+  Like the Original library and example this is under LGPL license.
+*/
+
+#include <PS2KeyAdvanced.h>
+#include <PS2KeyMap.h>
+#include <PS2KeyTrace.h>
+
+/* Keyboard constants  Change to suit your Arduino
+   define pins used for data and clock from keyboard */
+#define DATAPIN 4
+#define IRQPIN  3
+
+// Time with no keys before held back repeats are sent
+#define FLUSH_TIME 1000
+
+PS2KeyAdvanced keyboard;
+PS2KeyTraceEncoder trace;
+
+uint8_t buffer[PS2_TRACE_MAX_BYTES];
+uint32_t lastKey;
+
+
+void setup() {
+  Serial.begin(115200);
+  // Start keyboard setup, break codes are recorded as well
+  keyboard.begin(DATAPIN, IRQPIN);
+  lastKey = millis();
+}
+
+
+void loop() {
+  uint8_t count;
+
+  if (keyboard.available() > 0) {
+    lastKey = millis();
+    count = trace.encode(keyboard.read(), lastKey, buffer);
+    Serial.write(buffer, count);
+  }
+  else if (millis() - lastKey > FLUSH_TIME) {
+    count = trace.flush(buffer);
+    Serial.write(buffer, count);
+    lastKey = millis();
+  }
+}
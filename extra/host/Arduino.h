@@ -0,0 +1,38 @@
+/*
+  Arduino.h - host (Linux) build shim for PS2KeyMap library
+
+  Lets the library sources be compiled with a desktop compiler for tools
+  that replay or analyse key codes. Only what the library uses is provided.
+
+  Build with this directory before the library directories on the include
+  path and ARDUINO defined so PS2KeyAdvanced.h includes this file, e.g.
+
+    g++ -O2 -DARDUINO=100 -I extra/host -I src -I ../PS2KeyAdvanced/src ...
+*/
+
+#ifndef Arduino_h
+#define Arduino_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <time.h>
+
+// Flash access API when building the AVR (PS2_REQUIRES_PROGMEM) code paths
+#if defined(ARDUINO_ARCH_AVR)
+#include <avr/pgmspace.h>
+#endif
+
+// Arduino timers from the monotonic clock, wrapping at 32 bits as on a board
+static inline uint32_t micros() {
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint32_t)(now.tv_sec * 1000000ULL + now.tv_nsec / 1000);
+}
+
+static inline uint32_t millis() {
+  return micros() / 1000;
+}
+
+#endif  // Arduino_h
@@ -0,0 +1,94 @@
+/*
+  AsyncReplay.cpp - host (Linux) example of PS2KeyMapAsync.h
+
+  Replays a PS2KeyTrace capture (see examples/KeyTrace) through a
+  PS2KeyChannel into a remapBatches stream and writes the characters as UTF-8
+  to stdout, one batch at a time, with no callbacks in the consumer. The
+  channel is flushed after each block read from the file.
+
+  Build from the library directory (PS2KeyAdvanced installed next to it)
+
+    g++ -std=c++20 -O2 -DARDUINO=100 -I extra/host -I src -I ../PS2KeyAdvanced/src \
+        extra/host/AsyncReplay.cpp src/PS2KeyMap.cpp src/PS2KeyTrace.cpp \
+        -o asyncreplay
+
+  Usage
+    asyncreplay [-s] [file]     -s selects the Swedish map instead of US
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+*/
+
+#include <stdio.h>
+#include <Arduino.h>
+#include <PS2KeyAdvanced.h>
+#include <PS2KeyMap.h>
+#include <PS2KeyTrace.h>
+#include <PS2KeyMaps/Swedish.h>
+#include "PS2KeyMapAsync.h"
+
+typedef PS2KeyChannel<uint16_t, 256> Channel;
+
+static unsigned long lost = 0;
+
+
+static void pushKey(uint16_t keyCode, uint16_t, uint32_t, void* context) {
+  if (!((Channel*)context)->push(keyCode)) {
+    lost++;
+  }
+}
+
+
+static PS2KeyTask printKeys(PS2KeyMap& keymap, Channel& channel) {
+  PS2KeyBatches<uint16_t> keys = remapBatches(keymap, channel);
+
+  for (auto batch = co_await keys.next(); !batch.empty(); batch = co_await keys.next()) {
+    for (uint16_t code : batch) {
+      const uint8_t value = code & 0xFF;
+      if (value < 0x80) {
+        putchar(value == '\r' ? '\n' : value);
+      }
+      else {
+        putchar(0xC0 | (value >> 6));
+        putchar(0x80 | (value & 0x3F));
+      }
+    }
+  }
+}
+
+
+int main(int argc, char* argv[]) {
+  PS2KeyMap keymap;
+  Channel channel;
+  FILE* in = stdin;
+  uint8_t buffer[4096];
+  size_t length;
+  int arg = 1;
+
+  if (arg < argc && argv[arg][0] == '-' && argv[arg][1] == 's') {
+    keymap.setMap(&keyMap_Swedish);
+    arg++;
+  }
+  if (arg < argc) {
+    in = fopen(argv[arg], "rb");
+    if (in == NULL) {
+      perror(argv[arg]);
+      return 1;
+    }
+  }
+
+  PS2KeyTask consumer = printKeys(keymap, channel);
+  PS2KeyTraceDecoder decoder(pushKey, &channel);
+  while ((length = fread(buffer, 1, sizeof(buffer), in)) > 0) {
+    decoder.decode(buffer, length);
+    channel.flush();
+  }
+  channel.close();
+
+  if (lost > 0) {
+    fprintf(stderr, "asyncreplay: %lu codes lost\n", lost);
+  }
+  return consumer.done() ? 0 : 1;
+}
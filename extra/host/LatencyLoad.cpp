@@ -0,0 +1,150 @@
+/*
+  LatencyLoad.cpp - host (Linux) synthetic load generator for PS2KeyLatency
+
+  Emulates the loop() of a sketch like examples/International: key codes
+  arrive at random times (Poisson, given mean rate) into a 16 code buffer
+  like the one in PS2KeyAdvanced, the loop reads one key per pass, remaps it
+  with remapEvent and then spends the given time "printing" it. The loop also
+  spends the work time on passes without a key, as sketches doing other
+  jobs do.
+
+  Times are recorded for three stages and p50/p99 printed in microseconds,
+  plus the number of codes lost to a full buffer. As in examples/KeyLatency
+  they are counted from the last pass of the loop that found no key, not
+  from the real arrival time, so the figures match those of the sketch.
+
+    Stage 0 READ    key taken from buffer (includes buffer wait)
+    Stage 1 REMAP   after remapEvent
+    Stage 2 OUTPUT  after the output work
+
+  Build from the library directory (PS2KeyAdvanced installed next to it)
+
+    g++ -O2 -DARDUINO=100 -I extra/host -I src -I ../PS2KeyAdvanced/src \
+        extra/host/LatencyLoad.cpp src/PS2KeyMap.cpp src/PS2KeyLatency.cpp \
+        -o latencyload
+
+  Usage
+    latencyload [-n events] [-r keys per second] [-w work us] [-s]
+
+    Defaults are 20000 events at 2000 keys per second with 100 us of work,
+    -s selects the Swedish map instead of US.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <Arduino.h>
+#include <PS2KeyAdvanced.h>
+#include <PS2KeyMap.h>
+#include <PS2KeyLatency.h>
+#include <PS2KeyMaps/Swedish.h>
+
+#define STAGE_READ    0
+#define STAGE_REMAP   1
+#define STAGE_OUTPUT  2
+
+// Same size as the PS2KeyAdvanced key buffer
+#define BUFFER_SIZE   16
+
+static const char* stageNames[PS2_LATENCY_STAGES] = {"read", "remap", "output"};
+
+// Key codes typed, letters most often as in real text
+static const uint16_t keys[] = {
+  PS2_KEY_A, PS2_KEY_E, PS2_KEY_I, PS2_KEY_N, PS2_KEY_O,
+  PS2_KEY_R, PS2_KEY_S, PS2_KEY_T, PS2_KEY_SPACE, PS2_KEY_ENTER,
+  PS2_SHIFT + PS2_KEY_A, PS2_SHIFT + PS2_KEY_1, PS2_KEY_COMMA, PS2_KEY_DOT,
+  PS2_KEY_1, PS2_KEY_5, PS2_SHIFT + PS2_KEY_SEMI, PS2_KEY_APOS, PS2_KEY_OPEN_SQ,
+  PS2_ALT_GR + PS2_KEY_2, PS2_ALT_GR + PS2_KEY_EUROPE2, PS2_KEY_EUROPE2,
+  PS2_CAPS + PS2_KEY_SEMI, PS2_CTRL + PS2_KEY_C,
+};
+
+
+static void spin(uint32_t time) {
+  const uint32_t start = micros();
+
+  while (micros() - start < time) {
+  }
+}
+
+
+int main(int argc, char* argv[]) {
+  PS2KeyMap keymap;
+  PS2KeyLatency latency;
+  PS2KeyEvent_t buffer[BUFFER_SIZE];
+  uint32_t events = 20000;
+  double rate = 2000;
+  uint32_t work = 100;
+  uint32_t head = 0;
+  uint32_t tail = 0;
+  uint32_t sent = 0;
+  uint32_t lost = 0;
+  uint32_t idleTime;
+  uint32_t next;
+
+  for (int arg = 1; arg < argc; arg++) {
+    if (argv[arg][0] == '-' && argv[arg][1] == 's') {
+      keymap.setMap(&keyMap_Swedish);
+    }
+    else if (argv[arg][0] == '-' && arg + 1 < argc) {
+      switch (argv[arg][1]) {
+        case 'n': events = strtoul(argv[++arg], NULL, 0); break;
+        case 'r': rate = strtod(argv[++arg], NULL); break;
+        case 'w': work = strtoul(argv[++arg], NULL, 0); break;
+        default:
+                fprintf(stderr, "usage: %s [-n events] [-r rate] [-w work] [-s]\n", argv[0]);
+                return 1;
+      }
+    }
+  }
+
+  srand(1);
+  next = micros();
+  idleTime = next;
+  while (sent < events || head != tail) {
+    // Keyboard side, queue every key due by now, like PS2KeyAdvanced with no time
+    const uint32_t now = micros();
+    while (sent < events && (int32_t)(now - next) >= 0) {
+      if (head - tail < BUFFER_SIZE) {
+        buffer[head % BUFFER_SIZE].code = keys[rand() % (sizeof(keys) / sizeof(keys[0]))];
+        head++;
+      }
+      else {
+        lost++;
+      }
+      sent++;
+      next += (uint32_t)(-log((rand() + 1.0) / (RAND_MAX + 2.0)) * 1e6 / rate);
+    }
+
+    // Sketch side, one key per pass of loop()
+    if (head != tail) {
+      PS2KeyEvent_t event = buffer[tail % BUFFER_SIZE];
+      tail++;
+      event.time = idleTime;
+      latency.mark(STAGE_READ, &event, micros());
+      keymap.remapEvent(&event);
+      latency.mark(STAGE_REMAP, &event, micros());
+      spin(work);
+      latency.mark(STAGE_OUTPUT, &event, micros());
+    }
+    else {
+      idleTime = now;
+      spin(work);
+    }
+  }
+
+  printf("%lu events at %.0f keys/s, %lu us work, %lu lost\n",
+         (unsigned long)events, rate, (unsigned long)work, (unsigned long)lost);
+  printf("stage     samples      p50 us      p99 us\n");
+  for (uint8_t stage = 0; stage < PS2_LATENCY_STAGES; stage++) {
+    printf("%-8s %8lu  %10lu  %10lu\n", stageNames[stage],
+           (unsigned long)latency.samples(stage),
+           (unsigned long)latency.percentile(stage, 50),
+           (unsigned long)latency.percentile(stage, 99));
+  }
+  return 0;
+}
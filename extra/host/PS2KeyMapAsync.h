@@ -0,0 +1,363 @@
+/*
+  PS2KeyMapAsync.h - host (Linux) C++20 coroutine interface for PS2KeyMap
+
+  Turns any asynchronous source of raw PS2KeyAdvanced codes (replay files,
+  sockets, scan code decoders) into a lazy stream of remapped batches
+
+      PS2KeyBatches<uint16_t> keys = remapBatches(keymap, source);
+      for (auto batch = co_await keys.next(); !batch.empty(); batch = co_await keys.next()) {
+        for (uint16_t code : batch) ...
+      }
+
+  A source is any class with value_type (uint16_t or PS2KeyEvent_t) and a
+  read(std::span<value_type>) member returning an awaitable that gives the
+  number of codes copied, 0 at end of input. PS2KeyBufferSource (codes
+  already in memory) and PS2KeyChannel (codes pushed by callbacks) are
+  provided.
+
+  Batching and backpressure
+    remapBatches reads up to N codes per read() into a buffer in its
+    coroutine frame, remaps them in place dropping codes remapKey returns 0
+    for (function keys, break codes) and yields the rest as one span. It does
+    not read again until the consumer asks for the next batch, so a slow
+    consumer holds back the source.
+
+    PS2KeyChannel only resumes its reader when the producer calls flush()
+    or close(), e.g. once per chunk given to PS2KeyTraceDecoder::decode, so
+    the stream sees whole chunks as batches rather than one code at a time.
+    push() also resumes a waiting reader when the queue fills, and returns
+    false only if the queue is still full after that (no reader waiting).
+
+    Everything is templates, no virtual calls per key, and the only heap
+    allocations are the coroutine frames, one per stream and consumer task.
+
+  Host only, needs C++20 coroutines (g++ 10 or later with -std=c++20)
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+*/
+
+#ifndef PS2KeyMapAsync_h
+#define PS2KeyMapAsync_h
+
+#if __cplusplus < 202002L
+  #error PS2KeyMapAsync.h needs C++20
+#endif
+
+#include <algorithm>
+#include <concepts>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <span>
+#include <utility>
+
+#ifndef PS2KeyMap_h
+  #error PS2KeyMap.h must be included before PS2KeyMapAsync.h
+#endif
+
+
+/**
+ * Remaps one element in place, returns false if it has no printable code.
+ */
+inline bool ps2RemapInPlace(PS2KeyMap& keyMap, uint16_t& code) {
+  code = keyMap.remapKey(code);
+  return code != 0;
+}
+
+inline bool ps2RemapInPlace(PS2KeyMap& keyMap, PS2KeyEvent_t& event) {
+  return keyMap.remapEvent(&event) != 0;
+}
+
+
+/**
+ * Source of raw codes, see file header.
+ */
+template <typename Source>
+concept PS2KeySource = requires(Source& source, std::span<typename Source::value_type> into) {
+  { source.read(into).await_resume() } -> std::convertible_to<std::size_t>;
+};
+
+
+/**
+ * Awaitable that has its count ready, for sources that never wait.
+ */
+struct PS2KeyReady {
+  std::size_t count;
+
+  bool await_ready() const noexcept { return true; }
+  void await_suspend(std::coroutine_handle<>) const noexcept {}
+  std::size_t await_resume() const noexcept { return count; }
+};
+
+
+/**
+ * Lazy stream of batches of remapped codes or events, returned by
+ * remapBatches(). next() gives an empty span at the end of the source.
+ */
+template <typename T>
+class PS2KeyBatches {
+ public:
+  // Symmetric transfer back to whoever awaited next()
+  struct ResumeConsumer {
+    bool await_ready() const noexcept { return false; }
+    template <typename Promise>
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> producer) const noexcept {
+      return producer.promise().consumer;
+    }
+    void await_resume() const noexcept {}
+  };
+
+  struct promise_type {
+    std::span<const T> batch;
+    std::coroutine_handle<> consumer;
+    std::exception_ptr error;
+
+    PS2KeyBatches get_return_object() noexcept {
+      return PS2KeyBatches(std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    ResumeConsumer final_suspend() const noexcept { return {}; }
+    ResumeConsumer yield_value(std::span<const T> next) noexcept {
+      batch = next;
+      return {};
+    }
+    void return_void() noexcept { batch = {}; }
+    void unhandled_exception() noexcept {
+      error = std::current_exception();
+      batch = {};
+    }
+  };
+
+  struct NextAwaiter {
+    std::coroutine_handle<promise_type> producer;
+
+    bool await_ready() const noexcept { return !producer || producer.done(); }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> consumer) const noexcept {
+      producer.promise().consumer = consumer;
+      return producer;
+    }
+    std::span<const T> await_resume() const {
+      if (!producer) {
+        return {};
+      }
+      if (producer.promise().error) {
+        std::rethrow_exception(std::exchange(producer.promise().error, nullptr));
+      }
+      return producer.done() ? std::span<const T>() : producer.promise().batch;
+    }
+  };
+
+  PS2KeyBatches(PS2KeyBatches&& other) noexcept : mHandle(std::exchange(other.mHandle, nullptr)) {}
+  PS2KeyBatches& operator=(PS2KeyBatches&& other) noexcept {
+    if (this != &other) {
+      if (mHandle) {
+        mHandle.destroy();
+      }
+      mHandle = std::exchange(other.mHandle, nullptr);
+    }
+    return *this;
+  }
+  ~PS2KeyBatches() {
+    if (mHandle) {
+      mHandle.destroy();
+    }
+  }
+
+  /**
+   * Awaitable giving the next batch, valid until next() is awaited again.
+   */
+  NextAwaiter next() const noexcept { return NextAwaiter{mHandle}; }
+
+ private:
+  explicit PS2KeyBatches(std::coroutine_handle<promise_type> handle) noexcept : mHandle(handle) {}
+
+  std::coroutine_handle<promise_type> mHandle;
+};
+
+
+/**
+ * Returns a lazy stream of remapped batches of up to N codes from source.
+ * keyMap and source must outlive the stream, setMap() may be called between
+ * batches.
+ */
+template <std::size_t N = 32, PS2KeySource Source>
+PS2KeyBatches<typename Source::value_type> remapBatches(PS2KeyMap& keyMap, Source& source) {
+  using Element = typename Source::value_type;
+  Element buffer[N];
+
+  for (;;) {
+    const std::size_t count = co_await source.read(std::span<Element>(buffer, N));
+    if (count == 0) {
+      co_return;
+    }
+
+    std::size_t kept = 0;
+    for (std::size_t idx = 0; idx < count; idx++) {
+      Element element = buffer[idx];
+      if (ps2RemapInPlace(keyMap, element)) {
+        buffer[kept++] = element;
+      }
+    }
+    if (kept > 0) {
+      co_yield std::span<const Element>(buffer, kept);
+    }
+  }
+}
+
+
+/**
+ * Source of codes or events already in memory, e.g. a loaded replay file.
+ */
+template <typename E>
+class PS2KeyBufferSource {
+ public:
+  using value_type = E;
+
+  explicit PS2KeyBufferSource(std::span<const E> codes) noexcept : mCodes(codes) {}
+
+  PS2KeyReady read(std::span<E> into) noexcept {
+    const std::size_t count = std::min(into.size(), mCodes.size());
+    std::copy_n(mCodes.begin(), count, into.begin());
+    mCodes = mCodes.subspan(count);
+    return PS2KeyReady{count};
+  }
+
+ private:
+  std::span<const E> mCodes;
+};
+
+
+/**
+ * Bounded single threaded queue between callback code (socket handlers,
+ * PS2KeyTraceDecoder) and a remapBatches stream. A waiting reader is resumed
+ * from inside flush() or close(), or push() when the queue is full.
+ */
+template <typename E, std::size_t Capacity = 64>
+class PS2KeyChannel {
+ public:
+  using value_type = E;
+
+  // Lives in the reader's frame while it waits, so destroying a waiting
+  // stream or task removes the reader from the channel
+  struct ReadAwaiter {
+    PS2KeyChannel* channel;
+    std::span<E> into;
+    std::coroutine_handle<> reader = nullptr;
+
+    ~ReadAwaiter() {
+      if (reader && channel->mReader == reader) {
+        channel->mReader = nullptr;
+      }
+    }
+
+    bool await_ready() const noexcept { return channel->mCount > 0 || channel->mClosed; }
+    void await_suspend(std::coroutine_handle<> waiting) noexcept {
+      reader = waiting;
+      channel->mReader = waiting;
+    }
+    std::size_t await_resume() const noexcept { return channel->take(into); }
+  };
+
+  /**
+   * Queues one code without resuming the reader, unless the queue is full.
+   * Returns false (code not queued) when full with no reader to empty it,
+   * or after close().
+   */
+  bool push(const E& code) {
+    if (mCount == Capacity) {
+      wake();
+    }
+    if (mCount == Capacity || mClosed) {
+      return false;
+    }
+    mBuffer[(mHead + mCount) % Capacity] = code;
+    mCount++;
+    return true;
+  }
+
+  /**
+   * Resumes a waiting reader if codes are queued, call after each group of
+   * push() calls.
+   */
+  void flush() {
+    if (mCount > 0) {
+      wake();
+    }
+  }
+
+  /**
+   * Ends the input, read() gives 0 once the queue is empty.
+   */
+  void close() {
+    mClosed = true;
+    wake();
+  }
+
+  /**
+   * Returns number of codes that can be pushed before the queue is full.
+   */
+  std::size_t space() const noexcept { return Capacity - mCount; }
+
+  ReadAwaiter read(std::span<E> into) noexcept { return ReadAwaiter{this, into}; }
+
+ private:
+  void wake() {
+    if (mReader) {
+      std::exchange(mReader, nullptr).resume();
+    }
+  }
+
+  std::size_t take(std::span<E> into) noexcept {
+    const std::size_t count = std::min(into.size(), mCount);
+    for (std::size_t idx = 0; idx < count; idx++) {
+      into[idx] = mBuffer[mHead];
+      mHead = (mHead + 1) % Capacity;
+    }
+    mCount -= count;
+    return count;
+  }
+
+  E mBuffer[Capacity];
+  std::size_t mHead = 0;
+  std::size_t mCount = 0;
+  bool mClosed = false;
+  std::coroutine_handle<> mReader;
+};
+
+
+/**
+ * Minimal eagerly started coroutine to consume a stream from plain code,
+ * runs until its first wait inside the call that creates it.
+ */
+class PS2KeyTask {
+ public:
+  struct promise_type {
+    PS2KeyTask get_return_object() noexcept {
+      return PS2KeyTask(std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+    std::suspend_never initial_suspend() const noexcept { return {}; }
+    std::suspend_always final_suspend() const noexcept { return {}; }
+    void return_void() const noexcept {}
+    void unhandled_exception() const noexcept { std::terminate(); }
+  };
+
+  PS2KeyTask(PS2KeyTask&& other) noexcept : mHandle(std::exchange(other.mHandle, nullptr)) {}
+  PS2KeyTask& operator=(PS2KeyTask&&) = delete;
+  ~PS2KeyTask() {
+    if (mHandle) {
+      mHandle.destroy();
+    }
+  }
+
+  bool done() const noexcept { return !mHandle || mHandle.done(); }
+
+ private:
+  explicit PS2KeyTask(std::coroutine_handle<promise_type> handle) noexcept : mHandle(handle) {}
+
+  std::coroutine_handle<promise_type> mHandle;
+};
+
+#endif  // PS2KeyMapAsync_h
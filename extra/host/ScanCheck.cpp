@@ -0,0 +1,160 @@
+/*
+  ScanCheck.cpp - host (Linux) check of the PROGMEM table scan in PS2KeyMap
+
+  Remaps every key code (0 to 0xFFFF) with the US and Swedish maps and
+  either writes the results to a file or compares them with a file written
+  by another build. Built once as the plain C++ (RAM) path and once with
+  ARDUINO_ARCH_AVR, so the PROGMEM path and avr/pgmspace.h shim are used,
+  the two builds must give the same codes.
+
+  The PROGMEM build also prints the Flash reads (pgm_read_count) per lookup
+  of a printable key, every shift level of the 48 alphanumeric keys that
+  extra/keymapgen.py maps, with the cache emptied before each lookup.
+
+  This only checks the generic pgm_read_word form of PS2_PGM_READ_WORD_INC
+  used off AVR, not the LPM Z+ asm, and counts one read per word for both,
+  so it shows table scan cost per layout and not the gain of the asm.
+
+  Build from the library directory (PS2KeyAdvanced installed next to it)
+
+    g++ -O2 -DARDUINO=100 -I extra/host -I src -I ../PS2KeyAdvanced/src \
+        extra/host/ScanCheck.cpp src/PS2KeyMap.cpp -o scancheck-ram
+    g++ -O2 -DARDUINO=100 -DARDUINO_ARCH_AVR -I extra/host -I src \
+        -I ../PS2KeyAdvanced/src \
+        extra/host/ScanCheck.cpp src/PS2KeyMap.cpp -o scancheck-pgm
+
+  Usage
+    scancheck -w file     write results to file
+    scancheck file        compare results with file, exit 1 on differences
+
+    scancheck-ram -w ram.bin && scancheck-pgm ram.bin
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <Arduino.h>
+#include <PS2KeyAdvanced.h>
+#include <PS2KeyMap.h>
+#include <PS2KeyMaps/Swedish.h>
+
+#define CODES   0x10000UL
+
+static uint16_t results[CODES];
+static uint16_t expected[CODES];
+
+#if defined(PS2_REQUIRES_PROGMEM)
+// Alphanumeric keys in keyboard order, as KEYS in extra/keymapgen.py
+static const uint8_t printable[] = {
+  PS2_KEY_SINGLE, PS2_KEY_1, PS2_KEY_2, PS2_KEY_3, PS2_KEY_4, PS2_KEY_5,
+  PS2_KEY_6, PS2_KEY_7, PS2_KEY_8, PS2_KEY_9, PS2_KEY_0, PS2_KEY_MINUS,
+  PS2_KEY_EQUAL,
+  PS2_KEY_Q, PS2_KEY_W, PS2_KEY_E, PS2_KEY_R, PS2_KEY_T, PS2_KEY_Y,
+  PS2_KEY_U, PS2_KEY_I, PS2_KEY_O, PS2_KEY_P, PS2_KEY_OPEN_SQ, PS2_KEY_CLOSE_SQ,
+  PS2_KEY_A, PS2_KEY_S, PS2_KEY_D, PS2_KEY_F, PS2_KEY_G, PS2_KEY_H,
+  PS2_KEY_J, PS2_KEY_K, PS2_KEY_L, PS2_KEY_SEMI, PS2_KEY_APOS, PS2_KEY_BACK,
+  PS2_KEY_EUROPE2,
+  PS2_KEY_Z, PS2_KEY_X, PS2_KEY_C, PS2_KEY_V, PS2_KEY_B, PS2_KEY_N,
+  PS2_KEY_M, PS2_KEY_COMMA, PS2_KEY_DOT, PS2_KEY_DIV,
+};
+static const uint16_t levels[] = { 0, PS2_SHIFT, PS2_ALT_GR, PS2_SHIFT + PS2_ALT_GR };
+
+
+/**
+ * Prints average and worst Flash reads per printable key lookup.
+ */
+static void printReads(PS2KeyMap& keymap) {
+  uint32_t total = 0;
+  uint32_t worst = 0;
+  uint16_t lookups = 0;
+
+  for (uint8_t level = 0; level < sizeof(levels) / sizeof(levels[0]); level++) {
+    for (uint8_t key = 0; key < sizeof(printable); key++) {
+      keymap.clearCache();
+      pgm_read_count = 0;
+      keymap.remapKey(levels[level] + printable[key]);
+      total += pgm_read_count;
+      if (pgm_read_count > worst) {
+        worst = pgm_read_count;
+      }
+      lookups++;
+    }
+  }
+  printf("  %u printable lookups, %.1f Flash reads average, %lu worst",
+         lookups, (double)total / lookups, (unsigned long)worst);
+}
+#endif
+
+
+int main(int argc, char* argv[]) {
+  PS2KeyMap_t* layouts[] = { NULL, &keyMap_Swedish };
+  const char* names[] = { "US", "SE" };
+  PS2KeyMap keymap;
+  unsigned long failed = 0;
+  bool write;
+  FILE* file;
+
+  if (argc == 3 && strcmp(argv[1], "-w") == 0) {
+    write = true;
+  }
+  else if (argc == 2) {
+    write = false;
+  }
+  else {
+    fprintf(stderr, "usage: scancheck [-w] file\n");
+    return 2;
+  }
+  file = fopen(argv[argc - 1], write ? "wb" : "rb");
+  if (file == NULL) {
+    perror(argv[argc - 1]);
+    return 2;
+  }
+
+  for (uint8_t layout = 0; layout < 2; layout++) {
+    unsigned long differ = 0;
+
+    keymap.setMap(layouts[layout]);
+    for (uint32_t code = 0; code < CODES; code++) {
+      results[code] = keymap.remapKey(code);
+    }
+
+    if (write) {
+      if (fwrite(results, sizeof(results), 1, file) != 1) {
+        perror(argv[argc - 1]);
+        return 2;
+      }
+    }
+    else {
+      if (fread(expected, sizeof(expected), 1, file) != 1) {
+        fprintf(stderr, "scancheck: %s too short\n", argv[argc - 1]);
+        return 2;
+      }
+      for (uint32_t code = 0; code < CODES; code++) {
+        if (results[code] != expected[code]) {
+          if (differ < 10) {
+            printf("%s  0x%04lX  0x%04X expected 0x%04X\n", names[layout],
+                   (unsigned long)code, results[code], expected[code]);
+          }
+          differ++;
+        }
+      }
+      failed += differ;
+    }
+
+    printf("%s  %lu codes", names[layout], CODES);
+    if (!write) {
+      printf("  %lu differ", differ);
+    }
+#if defined(PS2_REQUIRES_PROGMEM)
+    printReads(keymap);
+#endif
+    printf("\n");
+  }
+
+  fclose(file);
+  return failed > 0 ? 1 : 0;
+}
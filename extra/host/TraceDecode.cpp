@@ -0,0 +1,78 @@
+/*
+  TraceDecode.cpp - host (Linux) decoder for PS2KeyTrace captures
+
+  Reads a trace written by PS2KeyTraceEncoder (see examples/KeyTrace) from a
+  file or stdin, remaps every key with the selected country map and prints
+  one line per event
+
+      time  raw code  remapped code  character
+
+  Build from the library directory (PS2KeyAdvanced installed next to it)
+
+    g++ -O2 -DARDUINO=100 -I extra/host -I src -I ../PS2KeyAdvanced/src \
+        extra/host/TraceDecode.cpp src/PS2KeyMap.cpp src/PS2KeyTrace.cpp \
+        -o tracedecode
+
+  Usage
+    tracedecode [-s] [file]     -s selects the Swedish map instead of US
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+*/
+
+#include <stdio.h>
+#include <Arduino.h>
+#include <PS2KeyAdvanced.h>
+#include <PS2KeyMap.h>
+#include <PS2KeyTrace.h>
+#include <PS2KeyMaps/Swedish.h>
+
+
+static void printEvent(uint16_t keyCode, uint16_t remapped, uint32_t time, void* context) {
+  FILE* out = (FILE*)context;
+
+  fprintf(out, "%10lu  0x%04X  0x%04X", (unsigned long)time, keyCode, remapped);
+  if ((remapped & 0xFF) >= 0x20 && (remapped & 0xFF) != 0x7F) {
+    // UTF-8 single byte codes printed as UTF-8
+    if ((remapped & 0xFF) < 0x80) {
+      fprintf(out, "  %c", remapped & 0xFF);
+    }
+    else {
+      fprintf(out, "  %c%c", 0xC0 | ((remapped & 0xFF) >> 6), 0x80 | (remapped & 0x3F));
+    }
+  }
+  fputc('\n', out);
+}
+
+
+int main(int argc, char* argv[]) {
+  PS2KeyMap keymap;
+  FILE* in = stdin;
+  uint8_t buffer[4096];
+  size_t length;
+  int arg = 1;
+
+  if (arg < argc && argv[arg][0] == '-' && argv[arg][1] == 's') {
+    keymap.setMap(&keyMap_Swedish);
+    arg++;
+  }
+  if (arg < argc) {
+    in = fopen(argv[arg], "rb");
+    if (in == NULL) {
+      perror(argv[arg]);
+      return 1;
+    }
+  }
+
+  PS2KeyTraceDecoder decoder(printEvent, stdout, &keymap);
+  while ((length = fread(buffer, 1, sizeof(buffer), in)) > 0) {
+    decoder.decode(buffer, length);
+  }
+  if (decoder.error()) {
+    fprintf(stderr, "tracedecode: invalid records in trace\n");
+    return 2;
+  }
+  return 0;
+}
@@ -0,0 +1,52 @@
+/*
+  avr/pgmspace.h - host (Linux) build shim of the AVR Flash access API
+
+  Lets the PS2_REQUIRES_PROGMEM code paths of the library, such as the
+  streaming table scan in PS2KeyMap::scanMap, be built and checked against
+  the plain C++ paths on a PC. Build with ARDUINO_ARCH_AVR defined so
+  PS2KeyAdvanced.h selects PROGMEM, e.g.
+
+    g++ -O2 -DARDUINO=100 -DARDUINO_ARCH_AVR -I extra/host -I src ...
+
+  Flash is ordinary memory here, every read is counted in pgm_read_count so
+  tools can report Flash accesses per lookup (see ScanCheck.cpp).
+*/
+
+#ifndef __PGMSPACE_H_
+#define __PGMSPACE_H_ 1
+
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+#define PSTR(s) (s)
+
+inline uint32_t pgm_read_count = 0;
+
+static inline uint8_t pgm_read_byte_shim(const void* address) {
+  pgm_read_count++;
+  return *(const uint8_t*)address;
+}
+
+static inline uint16_t pgm_read_word_shim(const void* address) {
+  uint16_t value;
+
+  pgm_read_count++;
+  memcpy(&value, address, sizeof(value));
+  return value;
+}
+
+static inline uint32_t pgm_read_dword_shim(const void* address) {
+  uint32_t value;
+
+  pgm_read_count++;
+  memcpy(&value, address, sizeof(value));
+  return value;
+}
+
+#define pgm_read_byte(address)   pgm_read_byte_shim(address)
+#define pgm_read_word(address)   pgm_read_word_shim(address)
+#define pgm_read_dword(address)  pgm_read_dword_shim(address)
+#define memcpy_P(dest, src, n)   memcpy((dest), (src), (n))
+
+#endif  // __PGMSPACE_H_
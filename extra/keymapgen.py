@@ -0,0 +1,510 @@
+#!/usr/bin/env python3
+"""keymapgen.py - PS2KeyMap country table generator
+
+  Reads a standard keyboard layout description and writes a PS2KeyMaps/*.h
+  header in the same style as PS2KeyMaps/Swedish.h, i.e. a table that ONLY
+  contains the differences from the US map in PS2KeyData.h.
+
+  Supported layout sources
+    XKB symbols file   e.g. /usr/share/X11/xkb/symbols/de
+                       A variant is selected with the XKB syntax "de(nodeadkeys)",
+                       include statements are resolved from the same directory
+                       (or --xkb-root)
+    Windows .klc file  as saved by Microsoft Keyboard Layout Creator
+                       (UTF-16 or UTF-8)
+
+  Only the alphanumeric block is mapped (TLDE, AE01-AE12, AD01-AD12, AC01-AC11,
+  BKSL, LSGT, AB01-AB10) with the four shift levels the library can see -
+  none, Shift, Alt Gr and Shift + Alt Gr. Characters outside the UTF-8 single
+  byte ranges (20-7E, A0-FF) cannot be returned by remapKey and are listed in
+  the report instead of the table. Dead keys are written as their spacing
+  character (dead_acute becomes PS2_ACUTE_ACCENT) as the library does not
+  compose characters.
+
+  A key level with no row in the table types the US character, so levels
+  that cannot be mapped are listed in the report with the US character they
+  fall back to.
+
+  The library scans tables linearly (see PS2KeyMap::scanMap), so the report
+  printed to stderr gives the table size in Flash and the lookup cost in rows
+  compared, for a hit in the country table and for keys that fall through to
+  the US table.
+
+  Usage
+    python3 keymapgen.py [options] LAYOUT
+
+    -c, --country XX   ISO country code (default from the layout file name)
+    -n, --name NAME    PS2KeyMap_t variable name (default keyMap_XX)
+    -o, --output FILE  header to write (default stdout)
+    --xkb-root DIR     directory to resolve XKB includes from (default the
+                       directory of LAYOUT, or /usr/share/X11/xkb/symbols
+                       for a name like "de(nodeadkeys)")
+    --src DIR          library src directory (default ../src next to this file)
+    --no-dead-keys     no rows for dead keys instead of the spacing character,
+                       they fall back to the US character (see report)
+    -q, --quiet        no report
+
+  Examples
+    python3 keymapgen.py -n keyMap_German -o ../src/PS2KeyMaps/German.h \\
+        /usr/share/X11/xkb/symbols/de
+    python3 keymapgen.py -c FR -n keyMap_French kbdfr.klc
+
+  This file is free software; you can redistribute it and/or modify it under
+  the terms of the GNU Lesser General Public License as published by the Free
+  Software Foundation; either version 2.1 of the License, or (at your option)
+  any later version.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+# Modifier bits as used in the tables (see PS2KeyAdvanced.h)
+SHIFT = 1
+ALT_GR = 2
+MOD_NAMES = {0: "", SHIFT: "PS2_SHIFT + ", ALT_GR: "PS2_ALT_GR + ",
+             SHIFT + ALT_GR: "PS2_SHIFT + PS2_ALT_GR + "}
+MOD_COMMENTS = {0: "without modifier keys", SHIFT: "with Shift key",
+                ALT_GR: "with Alt Gr key", SHIFT + ALT_GR: "with Shift + Alt Gr keys"}
+ROW_NAMES = ["Top row", "Second row", "Third row", "Fourth row"]
+
+# Key positions in keyboard order: XKB name, PS2_KEY_* suffix, KLC scan code, row
+KEYS = [
+    ("TLDE", "SINGLE", 0x29, 0),
+    ("AE01", "1", 0x02, 0), ("AE02", "2", 0x03, 0), ("AE03", "3", 0x04, 0),
+    ("AE04", "4", 0x05, 0), ("AE05", "5", 0x06, 0), ("AE06", "6", 0x07, 0),
+    ("AE07", "7", 0x08, 0), ("AE08", "8", 0x09, 0), ("AE09", "9", 0x0A, 0),
+    ("AE10", "0", 0x0B, 0), ("AE11", "MINUS", 0x0C, 0), ("AE12", "EQUAL", 0x0D, 0),
+    ("AD01", "Q", 0x10, 1), ("AD02", "W", 0x11, 1), ("AD03", "E", 0x12, 1),
+    ("AD04", "R", 0x13, 1), ("AD05", "T", 0x14, 1), ("AD06", "Y", 0x15, 1),
+    ("AD07", "U", 0x16, 1), ("AD08", "I", 0x17, 1), ("AD09", "O", 0x18, 1),
+    ("AD10", "P", 0x19, 1), ("AD11", "OPEN_SQ", 0x1A, 1), ("AD12", "CLOSE_SQ", 0x1B, 1),
+    ("AC01", "A", 0x1E, 2), ("AC02", "S", 0x1F, 2), ("AC03", "D", 0x20, 2),
+    ("AC04", "F", 0x21, 2), ("AC05", "G", 0x22, 2), ("AC06", "H", 0x23, 2),
+    ("AC07", "J", 0x24, 2), ("AC08", "K", 0x25, 2), ("AC09", "L", 0x26, 2),
+    ("AC10", "SEMI", 0x27, 2), ("AC11", "APOS", 0x28, 2), ("BKSL", "BACK", 0x2B, 2),
+    ("LSGT", "EUROPE2", 0x56, 3),
+    ("AB01", "Z", 0x2C, 3), ("AB02", "X", 0x2D, 3), ("AB03", "C", 0x2E, 3),
+    ("AB04", "V", 0x2F, 3), ("AB05", "B", 0x30, 3), ("AB06", "N", 0x31, 3),
+    ("AB07", "M", 0x32, 3), ("AB08", "COMMA", 0x33, 3), ("AB09", "DOT", 0x34, 3),
+    ("AB10", "DIV", 0x35, 3),
+]
+XKB_ALIASES = {"AC12": "BKSL"}
+
+# XKB keysym names for the UTF-8 single byte characters (keysym == code point)
+_LATIN1_NAMES = (
+    "space exclam quotedbl numbersign dollar percent ampersand apostrophe "
+    "parenleft parenright asterisk plus comma minus period slash "
+    "0 1 2 3 4 5 6 7 8 9 colon semicolon less equal greater question at "
+    "A B C D E F G H I J K L M N O P Q R S T U V W X Y Z "
+    "bracketleft backslash bracketright asciicircum underscore grave "
+    "a b c d e f g h i j k l m n o p q r s t u v w x y z "
+    "braceleft bar braceright asciitilde").split()
+_LATIN1_HIGH_NAMES = (
+    "nobreakspace exclamdown cent sterling currency yen brokenbar section "
+    "diaeresis copyright ordfeminine guillemotleft notsign hyphen registered macron "
+    "degree plusminus twosuperior threesuperior acute mu paragraph periodcentered "
+    "cedilla onesuperior masculine guillemotright onequarter onehalf threequarters questiondown "
+    "Agrave Aacute Acircumflex Atilde Adiaeresis Aring AE Ccedilla "
+    "Egrave Eacute Ecircumflex Ediaeresis Igrave Iacute Icircumflex Idiaeresis "
+    "ETH Ntilde Ograve Oacute Ocircumflex Otilde Odiaeresis multiply "
+    "Oslash Ugrave Uacute Ucircumflex Udiaeresis Yacute THORN ssharp "
+    "agrave aacute acircumflex atilde adiaeresis aring ae ccedilla "
+    "egrave eacute ecircumflex ediaeresis igrave iacute icircumflex idiaeresis "
+    "eth ntilde ograve oacute ocircumflex otilde odiaeresis division "
+    "oslash ugrave uacute ucircumflex udiaeresis yacute thorn ydiaeresis").split()
+KEYSYMS = {name: 0x20 + i for i, name in enumerate(_LATIN1_NAMES)}
+KEYSYMS.update({name: 0xA0 + i for i, name in enumerate(_LATIN1_HIGH_NAMES)})
+KEYSYMS.update({"guillemetleft": 0xAB, "guillemetright": 0xBB, "ordmasculine": 0xBA,
+                "Eth": 0xD0, "Ooblique": 0xD8, "Thorn": 0xDE, "ooblique": 0xF8})
+
+# Dead keys written as their spacing character
+DEAD_KEYS = {"dead_grave": 0x60, "dead_acute": 0xB4, "dead_circumflex": 0x5E,
+             "dead_tilde": 0x7E, "dead_diaeresis": 0xA8, "dead_cedilla": 0xB8,
+             "dead_macron": 0xAF, "dead_abovering": 0xB0, "dead_degree": 0xB0}
+
+NO_SYMBOL = ("NoSymbol", "VoidSymbol")
+
+# Where XKB symbols files are installed on Linux
+XKB_ROOT = "/usr/share/X11/xkb/symbols"
+
+
+class Layout:
+    """Characters per key position and shift level as code points.
+
+    A value of None means no character, a string holds the symbol name of a
+    character that cannot be returned by the library."""
+
+    def __init__(self, name):
+        self.name = name
+        self.keys = {}
+
+    def set(self, xkb_key, levels, mode="override"):
+        """Merges levels into a key as XKB does for the statement mode.
+
+        override  levels with a symbol replace the inherited ones
+        augment   only levels without an inherited symbol are set
+        replace   the whole key is replaced"""
+        key = XKB_ALIASES.get(xkb_key, xkb_key)
+        if mode == "replace" or key not in self.keys:
+            self.keys[key] = list(levels)
+            return
+        merged = self.keys[key] + [None] * (len(levels) - len(self.keys[key]))
+        for level, char in enumerate(levels):
+            if char is not None and (mode == "override" or merged[level] is None):
+                merged[level] = char
+        self.keys[key] = merged
+
+
+def keysym_to_char(sym, dead_keys):
+    """Returns a code point, None for no symbol or the name if not usable."""
+    if sym in NO_SYMBOL:
+        return None
+    if sym in KEYSYMS:
+        return KEYSYMS[sym]
+    if sym.startswith("dead_"):
+        return DEAD_KEYS.get(sym, sym) if dead_keys else sym
+    match = re.fullmatch(r"U([0-9A-Fa-f]{4,6})", sym)
+    if match:
+        return int(match.group(1), 16)
+    match = re.fullmatch(r"0x([0-9A-Fa-f]+)", sym)
+    if match:
+        value = int(match.group(1), 16)
+        if value >= 0x1000000:
+            return value - 0x1000000
+        if value <= 0xFF:
+            return value
+    return sym
+
+
+# ----------------------------------------------------------------- XKB reader
+def _xkb_blocks(text):
+    """Returns {variant: body} and the name of the default variant."""
+    text = re.sub(r"//.*", "", text)
+    blocks = {}
+    default = None
+    header = re.compile(r"((?:[a-z_]+\s+)*)xkb_symbols\s+\"([^\"]+)\"\s*\{")
+    pos = 0
+    while True:
+        match = header.search(text, pos)
+        if not match:
+            break
+        depth = 1
+        end = match.end()
+        while depth and end < len(text):
+            if text[end] == "{":
+                depth += 1
+            elif text[end] == "}":
+                depth -= 1
+            end += 1
+        name = match.group(2)
+        blocks[name] = text[match.end():end - 1]
+        # First block unless another one is marked default
+        if default is None or "default" in match.group(1).split():
+            default = name
+        pos = end
+    return blocks, default
+
+
+def _xkb_levels(body):
+    """Returns the group 1 symbol list of a key definition body."""
+    body = re.sub(r"\b(type|actions|virtualMods|vmods)\s*(\[\s*\w+\s*\])?\s*=\s*(\"[^\"]*\"|\[[^\]]*\]|\w+)\s*,?",
+                  "", body)
+    match = re.search(r"symbols\s*\[\s*Group1\s*\]\s*=\s*\[([^\]]*)\]", body)
+    if not match:
+        match = re.search(r"\[([^\]]*)\]", body)
+    if not match:
+        return None
+    return [sym.strip() for sym in match.group(1).split(",")]
+
+
+def read_xkb(spec, root, layout, dead_keys, mode="override", depth=0):
+    if depth > 16:
+        raise SystemExit("keymapgen: XKB include loop at %s" % spec)
+    match = re.fullmatch(r"([^()]+)(?:\(([^()]*)\))?", spec.strip())
+    if not match:
+        raise SystemExit("keymapgen: bad XKB name %s" % spec)
+    path, variant = match.group(1), match.group(2)
+    if not os.path.isfile(path):
+        path = os.path.join(root, path)
+    if not os.path.isfile(path):
+        raise SystemExit("keymapgen: XKB symbols file %s not found" % path)
+    with open(path, encoding="utf-8") as handle:
+        blocks, default = _xkb_blocks(handle.read())
+    variant = variant or default
+    if variant not in blocks:
+        raise SystemExit("keymapgen: no xkb_symbols \"%s\" in %s" % (variant, path))
+
+    statement = re.compile(
+        r"(include|augment|override|replace)\s+\"([^\"]+)\""
+        r"|(?:(override|replace|augment)\s+)?key\s+<(\w+)>\s*\{(.*?)\}\s*;", re.S)
+    for match in statement.finditer(blocks[variant]):
+        if match.group(1):
+            sub_mode = mode if match.group(1) == "include" else match.group(1)
+            for part in re.split(r"[+|]", match.group(2)):
+                part, _, group = part.partition(":")
+                if part and group in ("", "1"):
+                    read_xkb(part, root, layout, dead_keys, sub_mode, depth + 1)
+        else:
+            levels = _xkb_levels(match.group(5))
+            if levels is not None:
+                chars = [keysym_to_char(sym, dead_keys) for sym in levels[:4]]
+                layout.set(match.group(4), chars, match.group(3) or mode)
+
+
+# ----------------------------------------------------------------- KLC reader
+KLC_SECTIONS = ("KBD", "COPYRIGHT", "COMPANY", "LOCALENAME", "LOCALEID", "VERSION",
+                "SHIFTSTATE", "LAYOUT", "DEADKEY", "KEYNAME", "KEYNAME_EXT",
+                "KEYNAME_DEAD", "LIGATURE", "DESCRIPTIONS", "LANGUAGENAMES", "ENDKBD")
+# KLC shift state column value for each library shift level
+KLC_STATES = {0: 0, 1: SHIFT, 6: ALT_GR, 7: SHIFT + ALT_GR}
+
+
+def _klc_char(field, dead_keys):
+    if field in ("-1", "%%"):
+        return None
+    dead = field.endswith("@")
+    field = field.rstrip("@")
+    value = ord(field) if len(field) == 1 else int(field, 16)
+    if dead and not dead_keys:
+        return "dead_U%04X" % value
+    return value
+
+
+def read_klc(path, layout, dead_keys):
+    """Reads a .klc file and returns the country code from LOCALENAME."""
+    with open(path, "rb") as handle:
+        raw = handle.read()
+    if raw[:2] in (b"\xff\xfe", b"\xfe\xff"):
+        text = raw.decode("utf-16")
+    else:
+        text = raw.decode("utf-8-sig")
+    scan_codes = {key[2]: key[0] for key in KEYS}
+    columns = []
+    country = None
+    section = None
+    for line in text.splitlines():
+        line = line.split("//")[0].strip()
+        if not line:
+            continue
+        fields = line.split()
+        if fields[0] in KLC_SECTIONS:
+            section = fields[0]
+            if section == "LOCALENAME" and len(fields) > 1:
+                country = fields[1].strip("\"").split("-")[-1].upper()
+            continue
+        if section == "SHIFTSTATE":
+            columns.append(int(fields[0]))
+        elif section == "LAYOUT" and len(fields) > 3:
+            key = scan_codes.get(int(fields[0], 16)) if fields[0] != "-1" else None
+            if key is None:
+                continue
+            levels = [None] * 4
+            for column, field in zip(columns, fields[3:]):
+                if column in KLC_STATES:
+                    levels[KLC_STATES[column]] = _klc_char(field, dead_keys)
+            layout.set(key, levels)
+    return country
+
+
+# ------------------------------------------------------------- library data
+def read_us_table(src):
+    """Returns the rows of _US_ASCII as a list of ((mods, key), char)."""
+    with open(os.path.join(src, "PS2KeyData.h"), encoding="utf-8") as handle:
+        text = handle.read()
+    body = text[text.index("_US_ASCII"):]
+    body = body[:body.index("};")]
+    named = {"PS2_ENTER": 0x0D, "PS2_TAB": 0x09, "PS2_SPACE": 0x20}
+    rows = []
+    for match in re.finditer(r"\{\s*(PS2_SHIFT\s*\+\s*)?PS2_KEY_(\w+)\s*,\s*('(?:\\.|[^'])'|\w+)\s*\}", body):
+        value = match.group(3)
+        if value.startswith("'"):
+            value = value[1:-1]
+            value = ord(value[-1]) if value.startswith("\\") else ord(value)
+        else:
+            value = named.get(value, 0)
+        rows.append(((SHIFT if match.group(1) else 0, match.group(2)), value))
+    return rows
+
+
+def read_char_names(src):
+    """Returns {code point: (define name, glyph)} from PS2KeyMap.h."""
+    names = {}
+    with open(os.path.join(src, "PS2KeyMap.h"), encoding="utf-8") as handle:
+        for match in re.finditer(r"#define\s+(PS2_\w+)\s+(\d+)\s*//\s*\(0x\w+\)\s*(.*)", handle.read()):
+            names.setdefault(int(match.group(2)), (match.group(1), match.group(3).strip()))
+    return names
+
+
+def us_char(us_rows, mods, key):
+    """Emulates PS2KeyMap::remapKey for the US map only.
+
+    Returns the character or None when the library returns the raw key code."""
+    for row, value in us_rows:
+        if row == (mods, key):
+            return value
+    if mods & ALT_GR:
+        return 0
+    if len(key) == 1 and key.isalpha():
+        return ord(key) if mods & SHIFT else ord(key.lower())
+    if len(key) == 1 and key.isdigit():
+        return ord(key)
+    return None
+
+
+def usable(char):
+    return isinstance(char, int) and (0x20 <= char <= 0x7E or 0xA0 <= char <= 0xFF)
+
+
+def build_table(layout, us_rows):
+    """Returns the country map rows and the characters that cannot be mapped."""
+    rows = []
+    skipped = []
+    for row_number in range(len(ROW_NAMES)):
+        for mods in (0, SHIFT, ALT_GR, SHIFT + ALT_GR):
+            for xkb_key, key, _, key_row in KEYS:
+                if key_row != row_number or xkb_key not in layout.keys:
+                    continue
+                levels = layout.keys[xkb_key]
+                char = levels[mods] if mods < len(levels) else None
+                if usable(char):
+                    if char != us_char(us_rows, mods, key):
+                        rows.append((row_number, mods, key, char))
+                elif char is not None:
+                    skipped.append((mods, key, char))
+    return rows, skipped
+
+
+# ------------------------------------------------------------------- output
+def c_char(char, names):
+    if char == 0x27:
+        return "'\\''", None
+    if char == 0x5C:
+        return "'\\\\'", None
+    if char < 0x7F:
+        return "'%c'" % char, None
+    return names[char]
+
+
+def write_header(out, rows, country, map_name, source, names):
+    out.write("/**\n")
+    out.write(" * The key map shall only contain the differences from the US map.\n")
+    out.write(" *\n")
+    out.write(" * Generated by extra/keymapgen.py from %s\n" % source)
+    out.write(" */\n")
+    out.write("#pragma once\n\n")
+    out.write("#define COUNTRY_CODE \"%s\"\n" % country)
+    out.write("#define KEY_MAP_NAME %s\n\n" % map_name)
+    out.write("#if defined(PS2_REQUIRES_PROGMEM)\n")
+    out.write("static const uint16_t PROGMEM keyMap[][2] = {\n")
+    out.write("#else\n")
+    out.write("static const uint16_t keyMap[][2] = {\n")
+    out.write("#endif\n")
+    group = None
+    for row_number, mods, key, char in rows:
+        if group != (row_number, mods):
+            group = (row_number, mods)
+            out.write("  // %s, %s\n" % (ROW_NAMES[row_number], MOD_COMMENTS[mods]))
+        value, glyph = c_char(char, names)
+        line = "  {%sPS2_KEY_%s, %s}," % (MOD_NAMES[mods], key, value)
+        out.write(line + ("  // %s\n" % glyph if glyph else "\n"))
+    out.write("};\n\n")
+    out.write("PS2KeyMap_t KEY_MAP_NAME = {COUNTRY_CODE, sizeof(keyMap) / (2*sizeof(keyMap[0][0])), keyMap[0]};\n\n")
+    out.write("#undef COUNTRY_CODE\n")
+    out.write("#undef KEY_MAP_NAME\n")
+
+
+def fallback(us_rows, mods, key):
+    """Describes what remapKey returns for a key level with no country row."""
+    char = us_char(us_rows, mods, key)
+    if char is None:
+        return "key code"
+    if char == 0:
+        return "0 (no character)"
+    if char == 0x27:
+        return "US '\\''"
+    return "US '%c'" % char if 0x20 <= char < 0x7F else "US 0x%02X" % char
+
+
+def write_report(out, rows, skipped, us_rows, country, layout):
+    """Table size and scanMap cost, counted in rows compared per lookup."""
+    table = {(mods, key): index + 1 for index, (_, mods, key, _) in enumerate(rows)}
+    us_index = {row: index + 1 for index, (row, _) in enumerate(us_rows)}
+    hits = []
+    misses = []
+    for xkb_key, key, _, _ in KEYS:
+        if xkb_key not in layout.keys:
+            continue
+        for mods in (0, SHIFT, ALT_GR, SHIFT + ALT_GR):
+            char = layout.keys[xkb_key][mods] if mods < len(layout.keys[xkb_key]) else None
+            if char is None:
+                continue
+            if (mods, key) in table:
+                hits.append(table[(mods, key)])
+            else:
+                misses.append(len(rows) + us_index.get((mods, key), len(us_rows)))
+    lookups = hits + misses
+    out.write("%s: %d rows, %d bytes Flash (+%d bytes PS2KeyMap_t)\n"
+              % (country, len(rows), len(rows) * 4, 3 + 1 + 2))
+    out.write("  lookups  %d key/level combinations, %d in country table\n"
+              % (len(lookups), len(hits)))
+    if hits:
+        out.write("  hit      %.1f rows average, %d worst\n"
+                  % (sum(hits) / len(hits), max(hits)))
+    if misses:
+        out.write("  US       %.1f rows average, %d worst (country table + _US_ASCII)\n"
+                  % (sum(misses) / len(misses), max(misses)))
+    if lookups:
+        out.write("  overall  %.1f rows average per printable key\n" % (sum(lookups) / len(lookups)))
+    for mods, key, char in skipped:
+        name = char if isinstance(char, str) else "U+%04X" % char
+        reason = "dead key" if name.startswith("dead_") else "not UTF-8 single byte"
+        out.write("  no row   %sPS2_KEY_%s -> %s (%s), falls back to %s\n"
+                  % (MOD_NAMES[mods], key, name, reason, fallback(us_rows, mods, key)))
+
+
+def main():
+    here = os.path.dirname(os.path.abspath(__file__))
+    parser = argparse.ArgumentParser(description="Generate a PS2KeyMap country table")
+    parser.add_argument("layout", help="XKB symbols file [ (variant) ] or .klc file")
+    parser.add_argument("-c", "--country")
+    parser.add_argument("-n", "--name")
+    parser.add_argument("-o", "--output")
+    parser.add_argument("--xkb-root")
+    parser.add_argument("--src", default=os.path.join(here, "..", "src"))
+    parser.add_argument("--no-dead-keys", dest="dead_keys", action="store_false")
+    parser.add_argument("-q", "--quiet", action="store_true")
+    args = parser.parse_args()
+
+    layout = Layout(args.layout)
+    country = None
+    if args.layout.lower().endswith(".klc"):
+        country = read_klc(args.layout, layout, args.dead_keys)
+    else:
+        root = args.xkb_root
+        if root is None and os.path.isfile(args.layout.split("(")[0]):
+            root = os.path.dirname(os.path.abspath(args.layout.split("(")[0]))
+        elif root is None:
+            root = XKB_ROOT
+        read_xkb(args.layout, root, layout, args.dead_keys)
+    if args.country:
+        country = args.country.upper()
+    if not country:
+        country = os.path.basename(args.layout).split("(")[0].split(".")[0][:2].upper()
+    map_name = args.name or "keyMap_" + country
+
+    us_rows = read_us_table(args.src)
+    rows, skipped = build_table(layout, us_rows)
+    source = os.path.basename(args.layout)
+    if args.output:
+        with open(args.output, "w", encoding="utf-8") as out:
+            write_header(out, rows, country, map_name, source, read_char_names(args.src))
+    else:
+        write_header(sys.stdout, rows, country, map_name, source, read_char_names(args.src))
+    if not args.quiet:
+        write_report(sys.stderr, rows, skipped, us_rows, country, layout)
+
+
+if __name__ == "__main__":
+    main()
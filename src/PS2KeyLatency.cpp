@@ -0,0 +1,136 @@
+/*
+  PS2KeyLatency.cpp - PS2KeyMap library
+  Keystroke latency histograms for timestamped key events
+
+  See PS2KeyLatency.h for usage.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+/*------------------ Code starts here -------------------------*/
+#include <Arduino.h>
+// Internal headers for library defines/codes/etc
+#include <PS2KeyAdvanced.h>
+#include "PS2KeyMap.h"
+#include "PS2KeyLatency.h"
+
+
+/**
+ * Returns histogram bucket for a latency
+ *      0 and 1 have their own buckets
+ *      then 2 buckets per power of 2, lower and upper half
+ *      49152 (0xC000) and above all in last bucket
+ */
+static uint8_t bucketOf(uint32_t latency) {
+  uint8_t bit = 1;
+
+  if (latency < 2) {
+    return latency;
+  }
+  if (latency > 0xFFFF) {
+    return PS2_LATENCY_BUCKETS - 1;
+  }
+  while ((latency >> (bit + 1)) != 0) {
+    bit++;
+  }
+  return (bit << 1) | ((latency >> (bit - 1)) & 1);
+}
+
+
+/**
+ * Returns highest latency counted in a bucket, PS2_LATENCY_OVERFLOW for the last
+ * bucket as it has no upper limit.
+ */
+static uint32_t bucketTop(uint8_t bucket) {
+  const uint8_t bit = bucket >> 1;
+
+  if (bucket < 2) {
+    return bucket;
+  }
+  if (bucket == PS2_LATENCY_BUCKETS - 1) {
+    return PS2_LATENCY_OVERFLOW;
+  }
+  return ((uint32_t)1 << bit) + ((uint32_t)((bucket & 1) + 1) << (bit - 1)) - 1;
+}
+
+
+PS2KeyLatency::PS2KeyLatency() {
+  reset();
+}
+
+
+void PS2KeyLatency::reset() {
+  memset(mHistogram, 0, sizeof(mHistogram));
+}
+
+
+void PS2KeyLatency::mark(const uint8_t stage, const PS2KeyEvent_t* event, const uint32_t now) {
+  add(stage, now - event->time);
+}
+
+
+void PS2KeyLatency::add(const uint8_t stage, const uint32_t latency) {
+  if (stage >= PS2_LATENCY_STAGES) {
+    return;
+  }
+
+  uint16_t* histogram = mHistogram[stage];
+  const uint8_t bucket = bucketOf(latency);
+
+  if (histogram[bucket] == 0xFFFF) {
+    // Full, halve the stage keeping the shape of the distribution
+    for (uint8_t idx = 0; idx < PS2_LATENCY_BUCKETS; idx++) {
+      histogram[idx] >>= 1;
+    }
+  }
+  histogram[bucket]++;
+}
+
+
+uint32_t PS2KeyLatency::samples(const uint8_t stage) {
+  uint32_t count = 0;
+
+  if (stage < PS2_LATENCY_STAGES) {
+    for (uint8_t idx = 0; idx < PS2_LATENCY_BUCKETS; idx++) {
+      count += mHistogram[stage][idx];
+    }
+  }
+  return count;
+}
+
+
+uint32_t PS2KeyLatency::percentile(const uint8_t stage, const uint8_t percent) {
+  const uint32_t count = samples(stage);
+  uint32_t target;
+  uint32_t seen = 0;
+
+  if (count == 0) {
+    return 0;
+  }
+
+  // Number of samples at or below the percentile, at least 1
+  target = (count * percent + 99) / 100;
+  if (target == 0) {
+    target = 1;
+  }
+
+  for (uint8_t idx = 0; idx < PS2_LATENCY_BUCKETS; idx++) {
+    seen += mHistogram[stage][idx];
+    if (seen >= target) {
+      return bucketTop(idx);
+    }
+  }
+  return bucketTop(PS2_LATENCY_BUCKETS - 1);
+}
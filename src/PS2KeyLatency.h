@@ -0,0 +1,99 @@
+/*
+  PS2KeyLatency.h - PS2KeyMap library
+  Keystroke latency histograms for timestamped key events
+
+  Each PS2KeyEvent_t carries the time its key code was captured. As the event
+  passes a stage of the sketch (read, remapEvent, displayed, sent...) call
+  mark() with the current time and the time since capture is added to that
+  stage's histogram. Comparing p50/p99 of consecutive stages shows where the
+  time goes in loop().
+
+  Times are in whatever unit the caller uses, normally micros(). The
+  capture time is set by the sketch. PS2KeyAdvanced does not timestamp keys,
+  so a time taken when available() returns the key excludes the time the key
+  waited in the PS2KeyAdvanced buffer (e.g. during a delay() in loop()). Use
+  the time of the last poll that found no key, as examples/KeyLatency does,
+  to include it; the key arrived after that poll, so figures are then at
+  most one pass of loop() high. The keyboard itself needs about 1 ms to clock
+  out each byte before the key is in the buffer.
+
+  Histograms are fixed size, 2 buckets per power of 2 up to 49151 with
+  larger values counted in the last bucket. Percentiles are returned as the
+  top of the bucket they fall in, so are at most 50% above the real value.
+  When a bucket count would overflow, all counts of that stage are halved to
+  keep the distribution.
+
+  RAM used is PS2_LATENCY_STAGES * 64 bytes (192 bytes).
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef PS2KeyLatency_h
+#define PS2KeyLatency_h
+
+#include "PS2KeyMap.h"
+
+#define PS2_LATENCY_STAGES    3
+#define PS2_LATENCY_BUCKETS   32
+
+// Returned by percentile() for latencies above the histogram range
+#define PS2_LATENCY_OVERFLOW  0xFFFFFFFF
+
+
+class PS2KeyLatency {
+ public:
+  /**
+   * All histograms start empty.
+   */
+  PS2KeyLatency();
+
+  /**
+   * Empties all histograms.
+   */
+  void reset();
+
+  /**
+   * Adds the time from capture of the event until now to the histogram of
+   * the given stage (0 to PS2_LATENCY_STAGES - 1).
+   *
+   * Parameter stage  Stage number the event has reached.
+   * Parameter event  Event with its capture time.
+   * Parameter now    Current time in the same unit as the capture time.
+   */
+  void mark(const uint8_t stage, const PS2KeyEvent_t* event, const uint32_t now);
+
+  /**
+   * Adds an already measured latency to the histogram of the given stage.
+   */
+  void add(const uint8_t stage, const uint32_t latency);
+
+  /**
+   * Returns the latency that percent of the samples of the stage are below
+   * or equal to, e.g. 50 for p50 and 99 for p99. Returns 0 if no samples
+   * and PS2_LATENCY_OVERFLOW (0xFFFFFFFF) if the percentile is in the last
+   * bucket, i.e. 49152 or more.
+   */
+  uint32_t percentile(const uint8_t stage, const uint8_t percent);
+
+  /**
+   * Returns the number of samples in the histogram of the stage.
+   */
+  uint32_t samples(const uint8_t stage);
+
+ private:
+  uint16_t mHistogram[PS2_LATENCY_STAGES][PS2_LATENCY_BUCKETS];
+};
+
+#endif  // PS2KeyLatency_h
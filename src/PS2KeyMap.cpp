@@ -141,6 +141,11 @@
                         unsigned int as described above
     remapKeyByte() Returns uint8_t version of remapKey ONLY for standard ASCII/UTF-8 codes
                    Invalid codes returned as 0
+    remapEvent() Remaps the code of a PS2KeyEvent_t in place keeping its
+                 capture time, for use with PS2KeyLatency
+
+    clearCache()  Empties the lookup cache (see PS2_KEYMAP_CACHE_SIZE)
+    getCacheHits() getCacheMisses()  Lookup cache counters
 
   To create your own map to ADD to this library see the readme.txt file in
   the library directory
@@ -182,8 +187,43 @@
 #include "PS2KeyMap.h"
 #include "PS2KeyData.h"
 
+/* Read a word from Flash and advance the pointer to the next word.
+   On AVR this is two LPM Rd,Z+ instructions with the pointer held in Z, so a
+   table scan sets up Z once instead of reloading it for the key code word
+   of every row (not measured). AVR cores without LPM Rd,Z+ (LPMX), other
+   targets, and host builds using the pgm_read_* shim in extra/host use
+   pgm_read_word. */
+#if defined(__AVR__) && defined(__AVR_HAVE_LPMX__)
+#define PS2_PGM_READ_WORD_INC(ptr) (__extension__({  \
+    uint16_t __result;                               \
+    __asm__ __volatile__ (                           \
+      "lpm %A0, Z+" "\n\t"                           \
+      "lpm %B0, Z+" "\n\t"                           \
+      : "=&r" (__result), "+z" (ptr));               \
+    __result;                                        \
+  }))
+#else
+#define PS2_PGM_READ_WORD_INC(ptr) pgm_read_word((ptr)++)
+#endif
+
+
+#if PS2_KEYMAP_CACHE_SIZE > 0
+// Masked codes never have the Break bit set, so this marks an empty entry
+#define CACHE_EMPTY 0xFFFF
+
+/* Cache entry for a masked code, bottom byte with Shift and Alt Gr folded
+   into different bits of the index for every cache size */
+#define CACHE_INDEX(code) \
+  (((code) ^ ((((code) & PS2_ALT_GR) ? 0x55 : 0) ^ (((code) & PS2_SHIFT) ? 0xAA : 0))) & \
+   (PS2_KEYMAP_CACHE_SIZE - 1))
+#endif
+
 
 PS2KeyMap::PS2KeyMap() {
+#if PS2_KEYMAP_CACHE_SIZE > 0
+  mCacheHits = 0;
+  mCacheMisses = 0;
+#endif
   setMap(NULL);
 };
 
@@ -197,31 +237,77 @@ PS2KeyMap::PS2KeyMap() {
  * - First entry  (test[x][0]) is item to match
  * - Second entry (test[x][1]) is item to return
  *
+ * Flash tables are streamed a row at a time with PS2_PGM_READ_WORD_INC so
+ * on AVR the Z pointer is loaded once per table instead of per read.
+ *
  * Parameters are
  *      keyCode   unsigned int 16 from PS2KeyAdvanced::read().
  *      mapIndex  index of mapping table to use.
  */
 uint8_t PS2KeyMap::scanMap(const uint16_t keyCode, const PS2KeyMap_t* keyMap) {
   const uint16_t* mapArray = keyMap->map;
-  const uint16_t numWords = keyMap->numRows*2;  // Number of 16-bit ints in the map
 
-  // Scan Lookup Table (array) jumping 2 integers (i.e. one entry) at a time
-  for (uint16_t idx = 0; idx < numWords; idx += 2) {
 #if defined(PS2_REQUIRES_PROGMEM)
-    if (keyCode == pgm_read_word(mapArray + idx)) {
-      return (pgm_read_word(mapArray + idx + 1) & 0xFF);
+  // Read the match word of each row, skip the return word unless matched
+  for (uint8_t rows = keyMap->numRows; rows > 0; rows--) {
+    if (keyCode == PS2_PGM_READ_WORD_INC(mapArray)) {
+      return (pgm_read_word(mapArray) & 0xFF);
     }
+    mapArray++;
+  }
 #else
+  const uint16_t numWords = keyMap->numRows*2;  // Number of 16-bit ints in the map
+
+  // Scan Lookup Table (array) jumping 2 integers (i.e. one entry) at a time
+  for (uint16_t idx = 0; idx < numWords; idx += 2) {
     if (keyCode == *(mapArray + idx)) {
       return (*(mapArray + idx + 1) & 0xFF);
     }
-#endif
   }
+#endif
 
   return 0;
 }
 
 
+/**
+ * Searches the selected map then the US map for a masked key code, through
+ * the cache when there is one. Returns the character or 0 if not found.
+ *
+ * Parameter maskedCode  key code with only Shift, Alt Gr and bottom byte.
+ */
+uint8_t PS2KeyMap::lookupMaps(const uint16_t maskedCode) {
+  uint8_t remappedChar = 0;
+
+#if PS2_KEYMAP_CACHE_SIZE > 0
+  const uint8_t entry = CACHE_INDEX(maskedCode);
+
+  if (mCacheCode[entry] == maskedCode) {
+    mCacheHits++;
+    return mCacheChar[entry];
+  }
+  mCacheMisses++;
+#endif
+
+  if (mSelectedMap != &keyMap_UnitedStates) {
+    remappedChar = scanMap(maskedCode, mSelectedMap);
+  }
+
+  if (remappedChar == 0) {
+    // No value found in the country-specific map, check the US map instead
+    remappedChar = scanMap(maskedCode, &keyMap_UnitedStates);
+  }
+
+#if PS2_KEYMAP_CACHE_SIZE > 0
+  // Not found is cached as well, to skip scanning both maps next time
+  mCacheCode[entry] = maskedCode;
+  mCacheChar[entry] = remappedChar;
+#endif
+
+  return remappedChar;
+}
+
+
 void PS2KeyMap::setMap(PS2KeyMap_t* keyMap) {
   if (keyMap == NULL) {
     mSelectedMap = &keyMap_UnitedStates;
@@ -229,6 +315,34 @@ void PS2KeyMap::setMap(PS2KeyMap_t* keyMap) {
   else {
     mSelectedMap = keyMap;
   }
+  clearCache();
+}
+
+
+void PS2KeyMap::clearCache() {
+#if PS2_KEYMAP_CACHE_SIZE > 0
+  for (uint16_t entry = 0; entry < PS2_KEYMAP_CACHE_SIZE; entry++) {
+    mCacheCode[entry] = CACHE_EMPTY;
+  }
+#endif
+}
+
+
+uint32_t PS2KeyMap::getCacheHits() {
+#if PS2_KEYMAP_CACHE_SIZE > 0
+  return mCacheHits;
+#else
+  return 0;
+#endif
+}
+
+
+uint32_t PS2KeyMap::getCacheMisses() {
+#if PS2_KEYMAP_CACHE_SIZE > 0
+  return mCacheMisses;
+#else
+  return 0;
+#endif
 }
 
 
@@ -259,16 +373,7 @@ uint16_t PS2KeyMap::remapKey(const uint16_t keyCode) {
     returnCode = 0;
   }
   else {
-    uint8_t remappedChar = 0;
-
-    if (mSelectedMap != &keyMap_UnitedStates) {
-      remappedChar = scanMap(keyCode & (PS2_SHIFT + PS2_ALT_GR + 0x00FF), mSelectedMap);
-    }
-
-    if (remappedChar == 0) {
-      // No value found in the country-specific map, check the US map instead
-      remappedChar = scanMap(keyCode & (PS2_SHIFT + PS2_ALT_GR + 0x00FF), &keyMap_UnitedStates);
-    }
+    uint8_t remappedChar = lookupMaps(keyCode & (PS2_SHIFT + PS2_ALT_GR + 0x00FF));
 
     if (remappedChar == 0 && (keyCode & (PS2_CTRL + PS2_ALT + PS2_ALT_GR)) == 0) {
       // No value found in any map, try some standard replacements instead.
@@ -310,3 +415,9 @@ uint16_t PS2KeyMap::remapKey(const uint16_t keyCode) {
 uint8_t PS2KeyMap::remapKeyByte(const uint16_t code) {
   return (remapKey(code) & 0xFF);
 }
+
+
+uint16_t PS2KeyMap::remapEvent(PS2KeyEvent_t* event) {
+  event->code = remapKey(event->code);
+  return event->code;
+}
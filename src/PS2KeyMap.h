@@ -235,6 +235,24 @@
 #define PS2_y_DIAERESIS               255 // (0xFF) ÿ
 
 
+/* Number of entries (16, 32, 64, 128 or 256) in the RAM cache of table
+   lookups in each PS2KeyMap, or 0 for no cache. Each entry uses 3 bytes.
+   Repeated keys then skip scanning the tables, which helps most when tables
+   are held in slow storage. The library files must see the same value as
+   the sketch, so set it with a build flag that reaches every file, e.g.
+   -DPS2_KEYMAP_CACHE_SIZE=64 in PlatformIO build_flags or arduino-cli
+   --build-property "compiler.cpp.extra_flags=...", not a #define in the
+   sketch, or change the default here. */
+#ifndef PS2_KEYMAP_CACHE_SIZE
+#define PS2_KEYMAP_CACHE_SIZE   0
+#endif
+
+#if PS2_KEYMAP_CACHE_SIZE != 0 && (PS2_KEYMAP_CACHE_SIZE < 16 || PS2_KEYMAP_CACHE_SIZE > 256 || \
+    (PS2_KEYMAP_CACHE_SIZE & (PS2_KEYMAP_CACHE_SIZE - 1)) != 0)
+  #error PS2_KEYMAP_CACHE_SIZE must be 0 or a power of 2 from 16 to 256
+#endif
+
+
 // Meta data of a key map.
 typedef struct {
   const char countryCode[3];  // ISO country code (2 chars and null).
@@ -243,6 +261,13 @@ typedef struct {
 } PS2KeyMap_t;
 
 
+// Key code with the time it was captured, for latency measurements.
+typedef struct {
+  uint16_t code;  // Value from PS2KeyAdvanced::read(), remapped in place.
+  uint32_t time;  // Capture time, e.g. micros() of the last poll that found no key.
+} PS2KeyEvent_t;
+
+
 class PS2KeyMap {
  public:
   /**
@@ -278,10 +303,43 @@ class PS2KeyMap {
    */
   uint8_t remapKeyByte(const uint16_t keyCode);
 
+  /**
+   * Remaps the code of a timestamped event in place as remapKey does, the
+   * capture time is left unchanged. Returns the remapped code.
+   */
+  uint16_t remapEvent(PS2KeyEvent_t* event);
+
+  /**
+   * Empties the lookup cache, done by setMap. Call if the contents of the
+   * selected map have been changed.
+   */
+  void clearCache();
+
+  /**
+   * Returns number of table lookups answered from the cache since start,
+   * always 0 when PS2_KEYMAP_CACHE_SIZE is 0.
+   */
+  uint32_t getCacheHits();
+
+  /**
+   * Returns number of table lookups that had to scan the maps since start,
+   * always 0 when PS2_KEYMAP_CACHE_SIZE is 0.
+   */
+  uint32_t getCacheMisses();
+
  private:
+  uint8_t lookupMaps(const uint16_t maskedCode);
   uint8_t scanMap(const uint16_t keyCode, const PS2KeyMap_t* keyMap);
 
   PS2KeyMap_t* mSelectedMap;
+
+#if PS2_KEYMAP_CACHE_SIZE > 0
+  // Direct mapped cache of lookupMaps results, keyed on masked code
+  uint16_t mCacheCode[PS2_KEYMAP_CACHE_SIZE];
+  uint8_t mCacheChar[PS2_KEYMAP_CACHE_SIZE];
+  uint32_t mCacheHits;
+  uint32_t mCacheMisses;
+#endif
 };
 
 #endif  // PS2KeyMap_h
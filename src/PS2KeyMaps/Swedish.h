@@ -15,7 +15,7 @@ static const uint16_t keyMap[][2] = {
   {PS2_KEY_SINGLE, PS2_SECTION_SIGN},  // §
   {PS2_KEY_MINUS, '+'},
   {PS2_KEY_EQUAL, PS2_ACUTE_ACCENT},  // ´
-  // Top row, with Sihft key
+  // Top row, with Shift key
   {PS2_SHIFT + PS2_KEY_SINGLE, PS2_FRACTION_ONE_HALF},  // ½
   {PS2_SHIFT + PS2_KEY_2, '"'},
   {PS2_SHIFT + PS2_KEY_4, PS2_CURRENCY_SIGN},  // ¤
@@ -48,8 +48,8 @@ static const uint16_t keyMap[][2] = {
   {PS2_KEY_APOS, PS2_a_DIAERESIS}, // ä
   {PS2_KEY_BACK, '\''},
   // Third row, with Shift key
-  {PS2_SHIFT + PS2_KEY_SEMI, PS2_O_DIAERESIS},  // Ä
-  {PS2_SHIFT + PS2_KEY_APOS, PS2_A_DIAERESIS},  // Ö
+  {PS2_SHIFT + PS2_KEY_SEMI, PS2_O_DIAERESIS},  // Ö
+  {PS2_SHIFT + PS2_KEY_APOS, PS2_A_DIAERESIS},  // Ä
   {PS2_SHIFT + PS2_KEY_BACK, '*'},
   // Fourth row, without modifier keys
   {PS2_KEY_EUROPE2, '<'},
@@ -0,0 +1,280 @@
+/*
+  PS2KeyTrace.cpp - PS2KeyMap library
+  Compact event log of PS2KeyAdvanced::read() codes for capture and replay
+
+  See PS2KeyTrace.h for the trace format.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+/*------------------ Code starts here -------------------------*/
+#include <Arduino.h>
+// Internal headers for library defines/codes/etc
+#include <PS2KeyAdvanced.h>
+#include "PS2KeyMap.h"
+#include "PS2KeyTrace.h"
+
+// Decoder states, which byte of a record is expected next
+#define STATE_TAG       0
+#define STATE_MODS      1
+#define STATE_CODE      2
+#define STATE_VARINT    3
+#define STATE_RESIDUALS 4
+
+// REPEAT residual values, 00 and 01 are 0 and +1
+#define RESIDUAL_RESERVED 2
+#define RESIDUAL_MINUS    3
+
+
+/**
+ * Writes value as an unsigned LEB128 varint, returns number of bytes (1-5).
+ */
+static uint8_t putVarint(uint32_t value, uint8_t* buffer) {
+  uint8_t count = 0;
+
+  while (value > 0x7F) {
+    buffer[count++] = (value & 0x7F) | 0x80;
+    value >>= 7;
+  }
+  buffer[count++] = value;
+  return count;
+}
+
+
+PS2KeyTraceEncoder::PS2KeyTraceEncoder() {
+  reset();
+}
+
+
+void PS2KeyTraceEncoder::reset() {
+  mLastCode = 0;
+  mLastTime = 0;
+  mInterval = 0;
+  mRepeats = 0;
+  mJitter = false;
+  mStarted = false;
+}
+
+
+uint8_t PS2KeyTraceEncoder::writeKey(const uint16_t keyCode, const uint32_t delta, uint8_t* buffer) {
+  const uint8_t topChange = (keyCode ^ mLastCode) >> 8;
+  uint8_t count = 0;
+
+  buffer[count++] = (topChange ? PS2_TRACE_KEY_MODS : PS2_TRACE_KEY) |
+                    (delta < PS2_TRACE_SHORT_TIME ? delta : PS2_TRACE_SHORT_TIME);
+  if (topChange) {
+    buffer[count++] = topChange;
+  }
+  buffer[count++] = keyCode & 0xFF;
+  if (delta >= PS2_TRACE_SHORT_TIME) {
+    count += putVarint(delta - PS2_TRACE_SHORT_TIME, buffer + count);
+  }
+  return count;
+}
+
+
+uint8_t PS2KeyTraceEncoder::flush(uint8_t* buffer) {
+  uint8_t count = 0;
+
+  if (mRepeats > 0) {
+    buffer[count++] = PS2_TRACE_REPEAT | mRepeats;
+    count += putVarint((mInterval << 1) | (mJitter ? 1 : 0), buffer + count);
+    if (mJitter) {
+      for (uint8_t idx = 0; idx < (mRepeats + 3) >> 2; idx++) {
+        buffer[count++] = mResiduals[idx];
+      }
+    }
+    mRepeats = 0;
+  }
+  return count;
+}
+
+
+uint8_t PS2KeyTraceEncoder::encode(const uint16_t keyCode, const uint32_t time, uint8_t* buffer) {
+  const uint32_t delta = time - mLastTime;
+  uint8_t count = 0;
+
+  if (!mStarted) {
+    // New trace, absolute time then key against zero top byte
+    buffer[count++] = PS2_TRACE_TIME;
+    count += putVarint(time, buffer + count);
+    count += writeKey(keyCode, 0, buffer + count);
+    mStarted = true;
+  }
+  else if (keyCode == mLastCode && delta <= PS2_TRACE_MAX_INTERVAL) {
+    // Same key again, hold back as a run while the interval stays within 1
+    // of the first interval of the run, storing the difference
+    if (mRepeats > 0 && (delta + 1 < mInterval || delta > mInterval + 1)) {
+      count += flush(buffer);
+    }
+    if (mRepeats == 0) {
+      mInterval = delta;
+      mJitter = false;
+      memset(mResiduals, 0, sizeof(mResiduals));
+    }
+    else if (delta != mInterval) {
+      mResiduals[mRepeats >> 2] |= (delta > mInterval ? 1 : RESIDUAL_MINUS) << ((mRepeats & 3) << 1);
+      mJitter = true;
+    }
+    mRepeats++;
+    if (mRepeats == PS2_TRACE_MAX_REPEAT) {
+      count += flush(buffer + count);
+    }
+  }
+  else {
+    count += flush(buffer);
+    count += writeKey(keyCode, delta, buffer + count);
+  }
+
+  mLastCode = keyCode;
+  mLastTime = time;
+  return count;
+}
+
+
+PS2KeyTraceDecoder::PS2KeyTraceDecoder(PS2KeyTraceHandler handler, void* context, PS2KeyMap* keyMap) {
+  mHandler = handler;
+  mContext = context;
+  mKeyMap = keyMap;
+  reset();
+}
+
+
+void PS2KeyTraceDecoder::reset() {
+  mLastCode = 0;
+  mLastTime = 0;
+  mValue = 0;
+  mRepeats = 0;
+  mShift = 0;
+  mTag = 0;
+  mState = STATE_TAG;
+  mError = false;
+}
+
+
+bool PS2KeyTraceDecoder::error() {
+  return mError;
+}
+
+
+void PS2KeyTraceDecoder::emit(const uint32_t delta) {
+  mLastTime += delta;
+  mEvents++;
+  if (mHandler != NULL) {
+    mHandler(mLastCode, mKeyMap != NULL ? mKeyMap->remapKey(mLastCode) : 0, mLastTime, mContext);
+  }
+}
+
+
+/**
+ * Completes the record the varint belongs to, may set the next state.
+ */
+void PS2KeyTraceDecoder::endVarint() {
+  switch (mTag & PS2_TRACE_TYPE_MASK) {
+    case PS2_TRACE_KEY:
+    case PS2_TRACE_KEY_MODS:
+            emit(mValue + PS2_TRACE_SHORT_TIME);
+            break;
+    case PS2_TRACE_REPEAT:
+            mRepeats = mTag & PS2_TRACE_VALUE_MASK;
+            if ((mValue & 1) && mRepeats > 0) {
+              // Repeats follow with the residual bytes
+              mValue >>= 1;
+              mState = STATE_RESIDUALS;
+              break;
+            }
+            mValue >>= 1;
+            for (; mRepeats > 0; mRepeats--) {
+              emit(mValue);
+            }
+            break;
+    default:
+            // TIME starts a trace, the next key is against a zero top byte
+            mLastTime = mValue;
+            mLastCode = 0;
+            break;
+  }
+}
+
+
+uint32_t PS2KeyTraceDecoder::decode(const uint8_t* data, uint32_t length) {
+  mEvents = 0;
+
+  for (uint32_t idx = 0; idx < length; idx++) {
+    const uint8_t value = data[idx];
+
+    switch (mState) {
+      case STATE_TAG:
+              mTag = value;
+              mValue = 0;
+              mShift = 0;
+              if ((value & PS2_TRACE_TYPE_MASK) == PS2_TRACE_KEY_MODS) {
+                mState = STATE_MODS;
+              }
+              else if ((value & PS2_TRACE_TYPE_MASK) == PS2_TRACE_KEY) {
+                mState = STATE_CODE;
+              }
+              else if (value == PS2_TRACE_TIME ||
+                       (value & PS2_TRACE_TYPE_MASK) == PS2_TRACE_REPEAT) {
+                mState = STATE_VARINT;
+              }
+              else {
+                mError = true;  // Reserved tag, skip it
+              }
+              break;
+      case STATE_MODS:
+              mLastCode ^= (uint16_t)value << 8;
+              mState = STATE_CODE;
+              break;
+      case STATE_CODE:
+              mLastCode = (mLastCode & 0xFF00) | value;
+              if ((mTag & PS2_TRACE_VALUE_MASK) == PS2_TRACE_SHORT_TIME) {
+                mState = STATE_VARINT;
+              }
+              else {
+                emit(mTag & PS2_TRACE_VALUE_MASK);
+                mState = STATE_TAG;
+              }
+              break;
+      case STATE_RESIDUALS:
+              for (uint8_t slot = 0; slot < 8 && mRepeats > 0; slot += 2, mRepeats--) {
+                const uint8_t residual = (value >> slot) & 3;
+                if (residual == RESIDUAL_RESERVED) {
+                  mError = true;  // Taken as 0
+                }
+                emit(residual == RESIDUAL_MINUS ? mValue - 1 : mValue + (residual & 1));
+              }
+              if (mRepeats == 0) {
+                mState = STATE_TAG;
+              }
+              break;
+      default:
+              if (mShift > 28) {
+                mError = true;  // More than 32 bits, drop the record
+                mState = STATE_TAG;
+                break;
+              }
+              mValue |= (uint32_t)(value & 0x7F) << mShift;
+              mShift += 7;
+              if ((value & 0x80) == 0) {
+                mState = STATE_TAG;
+                endVarint();
+              }
+              break;
+    }
+  }
+
+  return mEvents;
+}
@@ -0,0 +1,188 @@
+/*
+  PS2KeyTrace.h - PS2KeyMap library
+  Compact event log of PS2KeyAdvanced::read() codes for capture and replay
+
+  Encoder is small enough to run next to PS2KeyMap on the keyboard device,
+  decoder is a byte at a time state machine so captures can be fed in any
+  size of chunks (serial reads, file blocks) and passed straight to
+  PS2KeyMap::remapKey.
+
+  Trace Format
+    A trace is a stream of records, each starting with a tag byte. Times are
+    in whatever unit the caller uses (millis() normally) and are stored as
+    differences from the previous event. Key codes keep the last top byte
+    (Break, Shift, Ctrl, Caps, Alt, Alt Gr, GUI, Function) so only changes
+    of the modifier state are stored.
+
+    Tag         Record          Followed by
+    00dddddd    KEY             bottom byte of code
+    01dddddd    KEY + MODIFIERS top byte XOR previous top byte, bottom byte
+    10nnnnnn    REPEAT          varint interval * 2 + jitter, residuals
+    11000000    TIME            varint absolute time
+    11xxxxxx    reserved (any other value)
+
+    dddddd  time since previous event 0 to 62, 63 = varint (time - 63)
+            follows the bottom byte
+    nnnnnn  previous key repeated 1 to 63 times, each one interval after
+            the event before it (auto-repeat), plus its residual
+
+    Typematic periods are not whole milliseconds, so the millis() times of
+    auto-repeats are up to 1 apart from a steady interval. When the jitter
+    bit is set the varint is followed by a 2 bit residual per repeat, 4 per
+    byte starting with bits 1-0, of 00 = 0, 01 = +1 and 11 = -1 (10 is
+    reserved), added to the interval. Without the jitter bit all residuals
+    are 0 and no residual bytes follow.
+
+    Varints are unsigned LEB128, 7 bits per byte, least significant first,
+    bit 7 set on all but the last byte (1 to 5 bytes for 32 bits).
+
+    Every trace starts with a TIME record holding the time of the first
+    event. TIME also restarts the modifier state, the key after it is
+    stored against a top byte of 0, so a trace restarted by reset() (or a
+    device restart) can be appended to a capture.
+
+    A key held down costs 2 or 3 bytes per 63 repeats when the interval is
+    steady, and 18 or 19 bytes when it jitters by a millisecond as it does
+    on hardware. A normal key press costs 2 or 3 bytes.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef PS2KeyTrace_h
+#define PS2KeyTrace_h
+
+#include "PS2KeyMap.h"
+
+// Record tags
+#define PS2_TRACE_KEY         0x00
+#define PS2_TRACE_KEY_MODS    0x40
+#define PS2_TRACE_REPEAT      0x80
+#define PS2_TRACE_TIME        0xC0
+#define PS2_TRACE_TYPE_MASK   0xC0
+#define PS2_TRACE_VALUE_MASK  0x3F
+
+// Largest time difference held in the tag byte, larger ones use a varint
+#define PS2_TRACE_SHORT_TIME  63
+// Largest repeat count held in one REPEAT record
+#define PS2_TRACE_MAX_REPEAT  63
+// Largest interval held in a REPEAT record, longer ones use KEY records
+#define PS2_TRACE_MAX_INTERVAL 0x7FFFFFFF
+
+// Buffer size needed for output of one call to encode() or flush()
+#define PS2_TRACE_MAX_BYTES   32
+
+
+class PS2KeyTraceEncoder {
+ public:
+  /**
+   * The first event encoded starts a new trace with a TIME record.
+   */
+  PS2KeyTraceEncoder();
+
+  /**
+   * Starts a new trace, the next event is written with a TIME record.
+   */
+  void reset();
+
+  /**
+   * Encodes one event into buffer, which must hold PS2_TRACE_MAX_BYTES.
+   * Returns the number of bytes written, which is 0 when the event is held
+   * back as part of a run of repeated keys.
+   *
+   * Parameter keyCode  The value returned by PS2KeyAdvanced::read().
+   * Parameter time     Time of the event, e.g. millis().
+   */
+  uint8_t encode(const uint16_t keyCode, const uint32_t time, uint8_t* buffer);
+
+  /**
+   * Writes any held back repeated keys into buffer, which must hold
+   * PS2_TRACE_MAX_BYTES. Call before closing or sending a trace.
+   * Returns the number of bytes written.
+   */
+  uint8_t flush(uint8_t* buffer);
+
+ private:
+  uint8_t writeKey(const uint16_t keyCode, const uint32_t delta, uint8_t* buffer);
+
+  uint16_t mLastCode;
+  uint32_t mLastTime;
+  uint32_t mInterval;
+  uint8_t mResiduals[(PS2_TRACE_MAX_REPEAT + 3) / 4];
+  uint8_t mRepeats;
+  bool mJitter;
+  bool mStarted;
+};
+
+
+/**
+ * Called by PS2KeyTraceDecoder for every event in the trace.
+ *
+ * Parameter keyCode   The value as returned by PS2KeyAdvanced::read().
+ * Parameter remapped  keyCode passed through PS2KeyMap::remapKey, or 0 if
+ *                     the decoder has no key map.
+ * Parameter time      Time of the event.
+ * Parameter context   Pointer given to the decoder constructor.
+ */
+typedef void (*PS2KeyTraceHandler)(uint16_t keyCode, uint16_t remapped,
+                                   uint32_t time, void* context);
+
+
+class PS2KeyTraceDecoder {
+ public:
+  /**
+   * Parameter handler  Called for every decoded event.
+   * Parameter context  Passed unchanged to handler.
+   * Parameter keyMap   If not NULL every event is remapped with this key map
+   *                    before calling handler.
+   */
+  PS2KeyTraceDecoder(PS2KeyTraceHandler handler, void* context, PS2KeyMap* keyMap = NULL);
+
+  /**
+   * Starts decoding a new trace.
+   */
+  void reset();
+
+  /**
+   * Decodes the next part of a trace, records may be split across calls.
+   * Returns the number of events passed to the handler.
+   */
+  uint32_t decode(const uint8_t* data, uint32_t length);
+
+  /**
+   * Returns true if a reserved tag or a too long varint has been seen since
+   * the last reset(), decoding continues with the next byte.
+   */
+  bool error();
+
+ private:
+  void emit(const uint32_t delta);
+  void endVarint();
+
+  PS2KeyTraceHandler mHandler;
+  void* mContext;
+  PS2KeyMap* mKeyMap;
+
+  uint16_t mLastCode;
+  uint32_t mLastTime;
+  uint32_t mValue;
+  uint32_t mEvents;
+  uint8_t mRepeats;
+  uint8_t mShift;
+  uint8_t mTag;
+  uint8_t mState;
+  bool mError;
+};
+
+#endif  // PS2KeyTrace_h